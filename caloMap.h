@@ -5,62 +5,79 @@
 #include <vector>
 using namespace std;
 
-inline map<pair<int,int>, vector<int>> GetCaloChMap() {
-    map<pair<int,int>, vector<int>> chMap;
+// Per-channel mapping entry: side (0=L, 1=R), physical module number,
+// column (0..7), layer (0..3) and GeomID (layer*8 + col + 1, 0 if unmapped)
+struct CaloChInfo {
+    int side;
+    int module;
+    int col;
+    int layer;
+    int geomID;
+};
+
+constexpr int kCaloMIDFirst = 41;  // MIDs 41, 42
+constexpr int kCaloNMID     = 2;
+constexpr int kCaloNChSlot  = 25;  // ch 1..24 (slot 0 unused)
+constexpr int kCaloNCh      = kCaloNMID * (kCaloNChSlot - 1); // 48 mapped channels
+constexpr int kCaloMaxGeom  = 32;  // 4 layers x 8 columns, GeomID 1..32
 
-    // MID 41
-    chMap[{41, 1}] = {1,  9, 0, 0};
-    chMap[{41, 2}] = {1, 24, 0, 1};
-    chMap[{41, 3}] = {1, 14, 0, 2};
-    chMap[{41, 4}] = {1, 13, 1, 0};
-    chMap[{41, 5}] = {1, 21, 1, 1};
-    chMap[{41, 6}] = {1, 10, 1, 2};
-    chMap[{41, 7}] = {1, 25, 2, 0};
-    chMap[{41, 8}] = {1, 23, 2, 1};
-    chMap[{41, 9}] = {1, 32, 2, 2};
-    chMap[{41,10}] = {1, 33, 3, 0};
-    chMap[{41,11}] = {1, 20, 3, 1};
-    chMap[{41,12}] = {1, 3, 3, 2};
-    chMap[{41,13}] = {0,  9, 0, 0};
-    chMap[{41,14}] = {0, 24, 0, 1};
-    chMap[{41,15}] = {0, 14, 0, 2};
-    chMap[{41,16}] = {0, 13, 1, 0};
-    chMap[{41,17}] = {0, 21, 1, 1};
-    chMap[{41,18}] = {0, 10, 1, 2};
-    chMap[{41,19}] = {0, 25, 2, 0};
-    chMap[{41,20}] = {0, 23, 2, 1};
-    chMap[{41,21}] = {0, 32, 2, 2};
-    chMap[{41,22}] = {0, 33, 3, 0};
-    chMap[{41,23}] = {0, 20, 3, 1};
-    chMap[{41,24}] = {0, 3, 3, 2};
+constexpr CaloChInfo CaloCh(int side, int module, int col, int layer) {
+    return CaloChInfo{side, module, col, layer, layer * 8 + col + 1};
+}
+constexpr CaloChInfo kCaloChNone = {-1, -1, -1, -1, 0};
+
+// Dense lookup table indexed by [MID - 41][ch]
+constexpr CaloChInfo kCaloChTable[kCaloNMID][kCaloNChSlot] = {
+    { // MID 41
+        kCaloChNone,
+        CaloCh(1,  9, 0, 0), CaloCh(1, 24, 0, 1), CaloCh(1, 14, 0, 2),
+        CaloCh(1, 13, 1, 0), CaloCh(1, 21, 1, 1), CaloCh(1, 10, 1, 2),
+        CaloCh(1, 25, 2, 0), CaloCh(1, 23, 2, 1), CaloCh(1, 32, 2, 2),
+        CaloCh(1, 33, 3, 0), CaloCh(1, 20, 3, 1), CaloCh(1,  3, 3, 2),
+        CaloCh(0,  9, 0, 0), CaloCh(0, 24, 0, 1), CaloCh(0, 14, 0, 2),
+        CaloCh(0, 13, 1, 0), CaloCh(0, 21, 1, 1), CaloCh(0, 10, 1, 2),
+        CaloCh(0, 25, 2, 0), CaloCh(0, 23, 2, 1), CaloCh(0, 32, 2, 2),
+        CaloCh(0, 33, 3, 0), CaloCh(0, 20, 3, 1), CaloCh(0,  3, 3, 2),
+    },
+    { // MID 42
+        kCaloChNone,
+        CaloCh(1, 26, 4, 0), CaloCh(1, 30, 4, 1), CaloCh(1, 29, 4, 2),
+        CaloCh(1, 18, 5, 0), CaloCh(1, 17, 5, 1), CaloCh(1, 31, 5, 2),
+        CaloCh(1, 27, 6, 0), CaloCh(1,  2, 6, 1), CaloCh(1, 28, 6, 2),
+        CaloCh(1,  6, 7, 0), CaloCh(1,  7, 7, 1), CaloCh(1, 15, 7, 2),
+        CaloCh(0, 26, 4, 0), CaloCh(0, 30, 4, 1), CaloCh(0, 29, 4, 2),
+        CaloCh(0, 18, 5, 0), CaloCh(0, 17, 5, 1), CaloCh(0, 31, 5, 2),
+        CaloCh(0, 27, 6, 0), CaloCh(0,  2, 6, 1), CaloCh(0, 28, 6, 2),
+        CaloCh(0,  6, 7, 0), CaloCh(0,  7, 7, 1), CaloCh(0, 15, 7, 2),
+    },
+};
 
-    // MID 42
-    chMap[{42, 1}] = {1, 26, 4, 0};
-    chMap[{42, 2}] = {1, 30, 4, 1};
-    chMap[{42, 3}] = {1, 29, 4, 2};
-    chMap[{42, 4}] = {1, 18, 5, 0};
-    chMap[{42, 5}] = {1, 17, 5, 1};
-    chMap[{42, 6}] = {1, 31, 5, 2};
-    chMap[{42, 7}] = {1, 27, 6, 0};
-    chMap[{42, 8}] = {1,  2, 6, 1};
-    chMap[{42, 9}] = {1, 28, 6, 2};
-    chMap[{42,10}] = {1,  6, 7, 0};
-    chMap[{42,11}] = {1,  7, 7, 1};
-    chMap[{42,12}] = {1, 15, 7, 2};
-    chMap[{42,13}] = {0, 26, 4, 0};
-    chMap[{42,14}] = {0, 30, 4, 1};
-    chMap[{42,15}] = {0, 29, 4, 2};
-    chMap[{42,16}] = {0, 18, 5, 0};
-    chMap[{42,17}] = {0, 17, 5, 1};
-    chMap[{42,18}] = {0, 31, 5, 2};
-    chMap[{42,19}] = {0, 27, 6, 0};
-    chMap[{42,20}] = {0,  2, 6, 1};
-    chMap[{42,21}] = {0, 28, 6, 2};
-    chMap[{42,22}] = {0,  6, 7, 0};
-    chMap[{42,23}] = {0,  7, 7, 1};
-    chMap[{42,24}] = {0, 15, 7, 2};
-    
+// Dense channel index 0..kCaloNCh-1 for (MID, ch), -1 if unmapped
+constexpr int GetCaloChIndex(int mid, int ch) {
+    return (mid < kCaloMIDFirst || mid >= kCaloMIDFirst + kCaloNMID ||
+            ch < 1 || ch >= kCaloNChSlot)
+               ? -1
+               : (mid - kCaloMIDFirst) * (kCaloNChSlot - 1) + (ch - 1);
+}
 
+// Mapping entry for a dense channel index (see GetCaloChIndex)
+constexpr const CaloChInfo& GetCaloChInfo(int chIndex) {
+    return kCaloChTable[chIndex / (kCaloNChSlot - 1)][chIndex % (kCaloNChSlot - 1) + 1];
+}
+
+static_assert(GetCaloChInfo(GetCaloChIndex(41, 1)).geomID == 1, "caloMap: MID41 ch1");
+static_assert(GetCaloChInfo(GetCaloChIndex(42, 24)).geomID == 24, "caloMap: MID42 ch24");
+static_assert(GetCaloChIndex(43, 1) == -1 && GetCaloChIndex(41, 25) == -1, "caloMap: range");
+
+// Legacy map view {MID,ch} -> {side, module, col, layer}, built from the table
+inline map<pair<int,int>, vector<int>> GetCaloChMap() {
+    map<pair<int,int>, vector<int>> chMap;
+    for (int idx = 0; idx < kCaloNCh; ++idx) {
+        const CaloChInfo& info = GetCaloChInfo(idx);
+        int mid = kCaloMIDFirst + idx / (kCaloNChSlot - 1);
+        int ch  = idx % (kCaloNChSlot - 1) + 1;
+        chMap[{mid, ch}] = {info.side, info.module, info.col, info.layer};
+    }
     return chMap;
 }
 
@@ -0,0 +1,120 @@
+#ifndef EDEP_CONVOLUTION_H
+#define EDEP_CONVOLUTION_H
+
+// Distribution of the summed module energy from the binned Edep histograms.
+// Modules are independent, as in the former GetRandom() toy. Each histogram
+// (bins 1..N, no under/overflow, like GetRandom) is a piecewise-constant
+// density: bin centres on a common grid of width w plus a U(-w/2, w/2)
+// offset. The bin-centre pmfs are convolved exactly by direct discrete
+// convolution, which is cheap for Edep histograms of a few hundred bins.
+// The sum of the M uniform offsets (Irwin-Hall) is then integrated over each
+// output bin after the correction factor. For histograms with a common bin
+// width this is exact. The result is deterministic and has unit area.
+
+#include "TH1.h"
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+namespace edep_detail {
+
+// Normalised bin contents on a grid of width w starting at the first non-empty bin centre
+struct GridPmf {
+    double origin = 0.0;
+    std::vector<double> p;
+};
+
+inline bool MakeGridPmf(const TH1* h, double w, GridPmf& pmf) {
+    int nBins = h->GetNbinsX();
+    int first = 0, last = 0;
+    double total = 0.0;
+    for (int b = 1; b <= nBins; ++b) {
+        double c = h->GetBinContent(b);
+        if (c <= 0) continue;
+        if (!first) first = b;
+        last = b;
+        total += c;
+    }
+    if (total <= 0) return false;
+    pmf.origin = h->GetBinCenter(first);
+    pmf.p.assign((size_t)std::lround((h->GetBinCenter(last) - pmf.origin) / w) + 1, 0.0);
+    for (int b = first; b <= last; ++b) {
+        double c = h->GetBinContent(b);
+        if (c <= 0) continue;
+        pmf.p[(size_t)std::lround((h->GetBinCenter(b) - pmf.origin) / w)] += c / total;
+    }
+    return true;
+}
+
+// P(sum of n independent U(-1/2, 1/2) < x)
+inline double UniformSumCdf(double x, int n) {
+    x += 0.5 * n;
+    if (x <= 0) return 0.0;
+    if (x >= n) return 1.0;
+    // the alternating Irwin-Hall sum loses precision for large n; the Gaussian limit is exact enough there
+    if (n > 12) return 0.5 * std::erfc(-(x - 0.5 * n) / std::sqrt(n / 6.0));
+    double fact = 1.0;
+    for (int i = 2; i <= n; ++i) fact *= i;
+    double sum = 0.0, binom = 1.0;
+    for (int k = 0; k <= (int)x; ++k) {
+        sum += ((k & 1) ? -binom : binom) * std::pow(x - k, n);
+        binom = binom * (n - k) / (k + 1);
+    }
+    return sum / fact;
+}
+
+} // namespace edep_detail
+
+// Fill out (after Reset) with the unit-area distribution of scale * (sum of the
+// module energies), scale > 0. Null or empty histograms contribute zero
+// energy, as GetRandom() did. Returns the number of modules convolved.
+inline int ConvolveEdepSum(const std::vector<const TH1*>& modules, double scale, TH1* out) {
+    out->Reset();
+    if (scale <= 0) return 0;
+    double w = 0.0;
+    for (const TH1* h : modules) {
+        if (!h) continue;
+        for (int b = 1; b <= h->GetNbinsX(); ++b) {
+            double bw = h->GetBinWidth(b);
+            if (bw > 0 && (w == 0.0 || bw < w)) w = bw;
+        }
+    }
+    if (w <= 0) return 0;
+
+    std::vector<double> sum(1, 1.0), next;
+    double origin = 0.0;
+    int nUsed = 0;
+    edep_detail::GridPmf pmf;
+    for (const TH1* h : modules) {
+        if (!h || !edep_detail::MakeGridPmf(h, w, pmf)) continue;
+        next.assign(sum.size() + pmf.p.size() - 1, 0.0);
+        for (size_t i = 0; i < sum.size(); ++i) {
+            if (sum[i] == 0.0) continue;
+            for (size_t j = 0; j < pmf.p.size(); ++j) next[i + j] += sum[i] * pmf.p[j];
+        }
+        sum.swap(next);
+        origin += pmf.origin;
+        ++nUsed;
+    }
+    if (!nUsed) return 0;
+
+    // Spread each bin-centre sum over its Irwin-Hall offset and integrate per output bin
+    const double halfSpread = 0.5 * nUsed * w;
+    for (size_t k = 0; k < sum.size(); ++k) {
+        if (sum[k] <= 0) continue;
+        double v = origin + k * w;
+        int bFirst = out->FindFixBin((v - halfSpread) * scale);
+        int bLast = out->FindFixBin((v + halfSpread) * scale);
+        double cdfLo = 0.0;
+        for (int b = bFirst; b <= bLast; ++b) {
+            double cdfHi = (b == bLast) ? 1.0
+                : edep_detail::UniformSumCdf((out->GetBinLowEdge(b + 1) / scale - v) / w, nUsed);
+            out->AddBinContent(b, sum[k] * (cdfHi - cdfLo));
+            cdfLo = cdfHi;
+        }
+    }
+    out->ResetStats(); // mean/RMS from the bin contents
+    return nUsed;
+}
+
+#endif // EDEP_CONVOLUTION_H
@@ -0,0 +1,56 @@
+#ifndef ENTRY_RANGE_MT_H
+#define ENTRY_RANGE_MT_H
+
+// Entry-range partitioning for the multi-threaded event loops.
+// Each worker gets one contiguous [first, last) slice of the tree and is
+// expected to open its own TFile/TTree and fill its own accumulators; the
+// caller merges them in worker order afterwards. With more threads than
+// entries some ranges are empty (first == last) and must read nothing;
+// TTreeReader::SetEntriesRange would treat such a range as open-ended.
+// RunJobsMT runs independent jobs (e.g. whole runs) on a bounded pool of
+// worker threads.
+
+#include "TROOT.h"
+#include <atomic>
+#include <functional>
+#include <thread>
+#include <vector>
+
+inline void RunEntryRangesMT(long long nEntries, int nThreads,
+                             const std::function<void(int, long long, long long)>& work) {
+    if (nThreads < 1) nThreads = 1;
+    if (nThreads == 1) {
+        work(0, 0, nEntries);
+        return;
+    }
+    ROOT::EnableThreadSafety();
+    std::vector<std::thread> workers;
+    long long chunk = nEntries / nThreads, rest = nEntries % nThreads;
+    long long first = 0;
+    for (int w = 0; w < nThreads; ++w) {
+        long long last = first + chunk + (w < rest ? 1 : 0);
+        workers.emplace_back(work, w, first, last);
+        first = last;
+    }
+    for (auto& t : workers) t.join();
+}
+
+// Run job(0) .. job(nJobs-1) on at most nWorkers threads; jobs are taken in order
+inline void RunJobsMT(int nJobs, int nWorkers, const std::function<void(int)>& job) {
+    if (nWorkers > nJobs) nWorkers = nJobs;
+    if (nWorkers <= 1) {
+        for (int j = 0; j < nJobs; ++j) job(j);
+        return;
+    }
+    ROOT::EnableThreadSafety();
+    std::atomic<int> next(0);
+    std::vector<std::thread> workers;
+    for (int w = 0; w < nWorkers; ++w) {
+        workers.emplace_back([&]() {
+            for (int j = next++; j < nJobs; j = next++) job(j);
+        });
+    }
+    for (auto& t : workers) t.join();
+}
+
+#endif // ENTRY_RANGE_MT_H
@@ -0,0 +1,332 @@
+#ifndef INT_ADC_CACHE_H
+#define INT_ADC_CACHE_H
+
+// Per-run integrated-ADC cache written by reduce_waveform_bic.C.
+// The "IntADC" tree holds one entry per event-builder event with the
+// integrated ADC of every mapped channel (dense caloMap.h index) for the
+// calibration and energy-calibration windows, the first trigger_time /
+// trigger_number and the 92-channel validity flag. IntADCSource reads
+// either that tree or the raw waveform tree, so both macros accept both.
+
+#include "TFile.h"
+#include "TTree.h"
+#include "TBranch.h"
+#include "TList.h"
+#include "TParameter.h"
+#include "TString.h"
+#include "caloMap.h"
+#include "waveformIntegral.h"
+#include <algorithm>
+#include <cstring>
+#include <iostream>
+#include <vector>
+
+constexpr const char* kIntADCTreeName = "IntADC";
+
+// Which quantities IntADCSource has to provide
+enum IntADCContent {
+    kIntADCCalib         = 1 << 0,  // calibration_bic.C window
+    kIntADCEnergy        = 1 << 1,  // energy_calibration_bic.C window
+    kIntADCTriggerTime   = 1 << 2,  // trigger_time
+    kIntADCTriggerNumber = 1 << 3   // trigger_number
+};
+
+// ADC integration windows relative to each channel's waveform_idx
+struct IntADCWindows {
+    int calibStart = 100;   // [idx+calibStart, idx+calibEnd)
+    int calibEnd = 200;
+    int energyStart = 0;    // [idx+energyStart, idx+energyEnd)
+    int energyEnd = -1;     // < 0: up to the next channel's waveform_idx
+    double pedestal = 0.0;  // per-sample pedestal
+};
+
+// Compare only the windows used for the requested content
+inline bool SameIntADCWindows(const IntADCWindows& a, const IntADCWindows& b, int content) {
+    if ((content & kIntADCCalib) && (a.calibStart != b.calibStart || a.calibEnd != b.calibEnd))
+        return false;
+    if ((content & kIntADCEnergy) && (a.energyStart != b.energyStart || a.energyEnd != b.energyEnd))
+        return false;
+    return a.pedestal == b.pedestal;
+}
+
+// One event in dense channel order
+struct IntADCEvent {
+    double adcCalib[kCaloNCh];
+    double adcEnergy[kCaloNCh];
+    unsigned long long chMask;  // bit idx set when dense channel idx is present
+    long long triggerTime;
+    int triggerNumber;
+    bool complete;              // data_length->size() == 92
+
+    bool Has(int idx) const { return (chMask >> idx) & 1ULL; }
+};
+static_assert(kCaloNCh <= 64, "IntADCEvent::chMask holds one bit per channel");
+
+// On-disk layout of one IntADC entry
+struct IntADCRecord {
+    Float_t intADCCalib[kCaloNCh];
+    Float_t intADCEnergy[kCaloNCh];
+    ULong64_t chMask;
+    Long64_t triggerTime;
+    Int_t triggerNumber;
+    Bool_t complete;
+};
+
+inline void BranchIntADCRecord(TTree* t, IntADCRecord& r) {
+    t->Branch("intADCCalib", r.intADCCalib, Form("intADCCalib[%d]/F", kCaloNCh));
+    t->Branch("intADCEnergy", r.intADCEnergy, Form("intADCEnergy[%d]/F", kCaloNCh));
+    t->Branch("chMask", &r.chMask, "chMask/l");
+    t->Branch("trigger_time", &r.triggerTime, "trigger_time/L");
+    t->Branch("trigger_number", &r.triggerNumber, "trigger_number/I");
+    t->Branch("complete", &r.complete, "complete/O");
+}
+
+inline void FillIntADCRecord(const IntADCEvent& ev, IntADCRecord& r) {
+    for (int idx = 0; idx < kCaloNCh; ++idx) {
+        r.intADCCalib[idx]  = static_cast<Float_t>(ev.adcCalib[idx]);
+        r.intADCEnergy[idx] = static_cast<Float_t>(ev.adcEnergy[idx]);
+    }
+    r.chMask        = ev.chMask;
+    r.triggerTime   = ev.triggerTime;
+    r.triggerNumber = ev.triggerNumber;
+    r.complete      = ev.complete;
+}
+
+// Windows are stored in the tree's UserInfo so readers can check them
+inline void WriteIntADCWindows(TTree* t, const IntADCWindows& w) {
+    TList* info = t->GetUserInfo();
+    info->Add(new TParameter<int>("calibStart", w.calibStart));
+    info->Add(new TParameter<int>("calibEnd", w.calibEnd));
+    info->Add(new TParameter<int>("energyStart", w.energyStart));
+    info->Add(new TParameter<int>("energyEnd", w.energyEnd));
+    info->Add(new TParameter<double>("pedestal", w.pedestal));
+}
+
+inline bool ReadIntADCWindows(TTree* t, IntADCWindows& w) {
+    TList* info = t->GetUserInfo();
+    auto* cs = dynamic_cast<TParameter<int>*>(info->FindObject("calibStart"));
+    auto* ce = dynamic_cast<TParameter<int>*>(info->FindObject("calibEnd"));
+    auto* es = dynamic_cast<TParameter<int>*>(info->FindObject("energyStart"));
+    auto* ee = dynamic_cast<TParameter<int>*>(info->FindObject("energyEnd"));
+    auto* ped = dynamic_cast<TParameter<double>*>(info->FindObject("pedestal"));
+    if (!cs || !ce || !es || !ee || !ped) return false;
+    w.calibStart = cs->GetVal();
+    w.calibEnd = ce->GetVal();
+    w.energyStart = es->GetVal();
+    w.energyEnd = ee->GetVal();
+    w.pedestal = ped->GetVal();
+    return true;
+}
+
+// Integrate one raw event-builder event into ev; layer < 0 keeps every layer
+inline void IntegrateRawEvent(const std::vector<short>& wave, const std::vector<int>& idx,
+                              const std::vector<int>& mid, const std::vector<int>& ch,
+                              const IntADCWindows& win, int content, int layer,
+                              IntADCEvent& ev) {
+    memset(ev.adcCalib, 0, sizeof(ev.adcCalib));
+    memset(ev.adcEnergy, 0, sizeof(ev.adcEnergy));
+    ev.chMask = 0;
+    size_t nCh = mid.size();
+    for (size_t j = 0; j < nCh; ++j) {
+        // only MID 41/42; unmapped channels are skipped
+        int chIdx = GetCaloChIndex(mid[j], ch[j]);
+        if (chIdx < 0) continue;
+        if (layer >= 0 && GetCaloChInfo(chIdx).layer != layer) continue;
+        if (j >= idx.size()) {
+            std::cout << "Warning: channel index " << j << " out of range for waveform_idx (size="
+                      << idx.size() << ")" << std::endl;
+            continue;
+        }
+        long base = idx[j];
+        // ADC/TDC가 번갈아 들어있으므로 짝수 bin만 읽기 (ADC만)
+        if (content & kIntADCCalib) {
+            ev.adcCalib[chIdx] += IntegrateADC(wave, base + win.calibStart, base + win.calibEnd,
+                                               win.pedestal);
+        }
+        if (content & kIntADCEnergy) {
+            long chEnd = (j + 1 < nCh && j + 1 < idx.size()) ? idx[j + 1] : (long)wave.size();
+            long end = (win.energyEnd < 0) ? chEnd : std::min(chEnd, base + win.energyEnd);
+            ev.adcEnergy[chIdx] += IntegrateADC(wave, base + win.energyStart, end, win.pedestal);
+        }
+        ev.chMask |= 1ULL << chIdx;
+    }
+}
+
+// TTreeCache / prefetch settings of an IntADCSource
+struct IntADCReadOptions {
+    long long cacheSize = -1;  // TTreeCache size in bytes; < 0: ROOT default, 0: no cache
+    bool prefetch = false;     // prefetch all baskets of the current cluster
+};
+
+// Read statistics of one IntADCSource
+struct IntADCReadStats {
+    long long nRead = 0;       // entries loaded
+    long long nRejected = 0;   // rejected on data_length (or the cached flag) before the waveform was unpacked
+    long long bytesRead = 0;   // bytes read from the file by this source
+
+    IntADCReadStats& operator+=(const IntADCReadStats& o) {
+        nRead += o.nRead;
+        nRejected += o.nRejected;
+        bytesRead += o.bytesRead;
+        return *this;
+    }
+};
+
+inline void PrintIntADCReadStats(const IntADCReadStats& s) {
+    std::cout << "Read " << s.nRead << " entries, " << s.nRejected
+              << " rejected before waveform unpacking, " << s.bytesRead / (1024. * 1024.)
+              << " MB read from file" << std::endl;
+}
+
+// Event source over either a raw waveform tree or an IntADC cache tree.
+// Only the branches needed for the requested content are enabled; the small
+// data_length (or cached complete) branch is read first and the waveform
+// (or integrated-ADC) branches are decompressed and deserialised only for
+// events that pass the 92-channel cut. With the TTreeCache on, their
+// compressed baskets are still fetched for whole clusters, rejected events
+// included, so the cut saves CPU rather than bytes read.
+class IntADCSource {
+public:
+    IntADCSource(TTree* tree, const IntADCWindows& win, int content, int layer = -1,
+                 const IntADCReadOptions& opts = IntADCReadOptions())
+        : fTree(tree), fWin(win), fContent(content), fLayer(layer) {
+        fCached = (tree->GetBranch("intADCCalib") != nullptr);
+        fFile = tree->GetCurrentFile();
+        fBytesStart = fFile ? fFile->GetBytesRead() : 0;
+
+        tree->SetCacheSize(opts.cacheSize);
+        fUseCache = (opts.cacheSize != 0);
+        if (opts.prefetch) tree->SetClusterPrefetch(true);
+        tree->SetBranchStatus("*", false);
+
+        if (fCached) {
+            IntADCWindows cached;
+            if (ReadIntADCWindows(tree, cached)) {
+                if (!SameIntADCWindows(cached, win, content)) {
+                    std::cout << "Warning: IntADC cache was reduced with windows calib ["
+                              << cached.calibStart << "," << cached.calibEnd << ") energy ["
+                              << cached.energyStart << "," << cached.energyEnd << ") pedestal "
+                              << cached.pedestal << "; using the cached values" << std::endl;
+                }
+                fWin = cached;
+            }
+            fBrSelect = EnableBranch("complete", &fRec.complete);
+            fBrMask = EnableBranch("chMask", &fRec.chMask);
+            if (content & kIntADCCalib) fBrCalib = EnableBranch("intADCCalib", fRec.intADCCalib);
+            if (content & kIntADCEnergy) fBrEnergy = EnableBranch("intADCEnergy", fRec.intADCEnergy);
+            if (content & kIntADCTriggerTime) fBrTrigTime = EnableBranch("trigger_time", &fRec.triggerTime);
+            if (content & kIntADCTriggerNumber) fBrTrigNum = EnableBranch("trigger_number", &fRec.triggerNumber);
+        } else {
+            fBrSelect = EnableBranch("data_length", &fDataLength);
+            fBrMID = EnableBranch("MID", &fMID);
+            fBrCh = EnableBranch("ch", &fCh);
+            fBrIdx = EnableBranch("waveform_idx", &fIdx);
+            fBrWave = EnableBranch("waveform_total", &fWave);
+            if (content & kIntADCTriggerTime) fBrTrigTime = EnableBranch("trigger_time", &fTriggerTime);
+            if (content & kIntADCTriggerNumber) fBrTrigNum = EnableBranch("trigger_number", &fTriggerNumber);
+        }
+        if (fUseCache) tree->StopCacheLearningPhase();
+    }
+    ~IntADCSource() {
+        fTree->ResetBranchAddresses();
+        fTree->SetBranchStatus("*", true);
+    }
+
+    bool IsCached() const { return fCached; }
+    const IntADCWindows& Windows() const { return fWin; }
+    const IntADCEvent& Event() const { return fEv; }
+
+    IntADCReadStats Stats() const {
+        IntADCReadStats s = fStats;
+        s.bytesRead = fFile ? fFile->GetBytesRead() - fBytesStart : 0;
+        return s;
+    }
+
+    // Load entry i; false (no channels, all integrals zero) for events missing some of the 92 channels
+    bool Load(Long64_t i) {
+        ++fStats.nRead;
+        Long64_t local = fTree->LoadTree(i);
+        if (local < 0 || !fBrSelect) return false;
+        fBrSelect->GetEntry(local);
+        if (fBrTrigTime) fBrTrigTime->GetEntry(local);
+        if (fBrTrigNum) fBrTrigNum->GetEntry(local);
+
+        if (fCached) {
+            fEv.triggerTime   = fRec.triggerTime;
+            fEv.triggerNumber = fRec.triggerNumber;
+            fEv.complete      = fRec.complete;
+        } else {
+            fEv.triggerTime = (fTriggerTime && !fTriggerTime->empty()) ? fTriggerTime->at(0) : 0;
+            fEv.triggerNumber = (fTriggerNumber && !fTriggerNumber->empty()) ? fTriggerNumber->at(0) : 0;
+            // data_length.size()=92가 아닌 경우 이벤트 스킵 (92개 채널이 모두 켜진 이벤트만)
+            fEv.complete = (fDataLength && fDataLength->size() == 92);
+        }
+        if (!fEv.complete) {
+            // no values from the previous event, also for readers that ignore chMask
+            memset(fEv.adcCalib, 0, sizeof(fEv.adcCalib));
+            memset(fEv.adcEnergy, 0, sizeof(fEv.adcEnergy));
+            fEv.chMask = 0;
+            ++fStats.nRejected;
+            return false;
+        }
+
+        if (fCached) {
+            fBrMask->GetEntry(local);
+            if (fBrCalib) fBrCalib->GetEntry(local);
+            if (fBrEnergy) fBrEnergy->GetEntry(local);
+            for (int idx = 0; idx < kCaloNCh; ++idx) {
+                fEv.adcCalib[idx]  = fRec.intADCCalib[idx];
+                fEv.adcEnergy[idx] = fRec.intADCEnergy[idx];
+            }
+            fEv.chMask = fRec.chMask;
+            return true;
+        }
+        fBrMID->GetEntry(local);
+        fBrCh->GetEntry(local);
+        fBrIdx->GetEntry(local);
+        fBrWave->GetEntry(local);
+        IntegrateRawEvent(*fWave, *fIdx, *fMID, *fCh, fWin, fContent, fLayer, fEv);
+        return true;
+    }
+
+private:
+    template <class T>
+    TBranch* EnableBranch(const char* name, T* addr) {
+        TBranch* br = nullptr;
+        fTree->SetBranchStatus(name, true);
+        fTree->SetBranchAddress(name, addr, &br);
+        if (br && fUseCache) fTree->AddBranchToCache(br, true);
+        return br;
+    }
+
+    TTree* fTree;
+    TFile* fFile = nullptr;
+    IntADCWindows fWin;
+    int fContent;
+    int fLayer;
+    bool fCached = false;
+    bool fUseCache = false;
+    long long fBytesStart = 0;
+    IntADCReadStats fStats;
+    IntADCEvent fEv = {};
+    IntADCRecord fRec = {};
+    TBranch* fBrSelect = nullptr;   // data_length or complete
+    TBranch* fBrMask = nullptr;
+    TBranch* fBrCalib = nullptr;
+    TBranch* fBrEnergy = nullptr;
+    TBranch* fBrMID = nullptr;
+    TBranch* fBrCh = nullptr;
+    TBranch* fBrIdx = nullptr;
+    TBranch* fBrWave = nullptr;
+    TBranch* fBrTrigTime = nullptr;
+    TBranch* fBrTrigNum = nullptr;
+    std::vector<short>* fWave = nullptr;
+    std::vector<int>* fIdx = nullptr;
+    std::vector<int>* fMID = nullptr;
+    std::vector<int>* fCh = nullptr;
+    std::vector<int>* fDataLength = nullptr;
+    std::vector<long long>* fTriggerTime = nullptr;
+    std::vector<int>* fTriggerNumber = nullptr;
+};
+
+#endif // INT_ADC_CACHE_H
@@ -0,0 +1,46 @@
+#ifndef RUN_TAG_H
+#define RUN_TAG_H
+
+#include <cstring>
+#include <cstdio>
+
+// Extract run tag from filename (per-thread buffer, valid until the next call)
+inline const char* extractRunTag(const char* dataFile) {
+  static thread_local char buf[128];
+  const char* fname = strrchr(dataFile, '/');
+  fname = (fname ? fname + 1 : dataFile);
+  
+  const char* runptr = strstr(fname, "Run_");
+  if (runptr) {
+    int runnum = 0;
+    if (sscanf(runptr, "Run_%d", &runnum) == 1) {
+      snprintf(buf, sizeof(buf), "Run%d", runnum);
+      return buf;
+    }
+  }
+  
+  // "<tag>_Waveform.root" (raw) or "<tag>_IntADC.root" (integrated-ADC cache)
+  const char* wptr = strstr(fname, "_Waveform");
+  if (!wptr) wptr = strstr(fname, "_IntADC");
+  if (wptr && wptr > fname) {
+    size_t len = wptr - fname;
+    if (len > sizeof(buf)-1) len = sizeof(buf)-1;
+    strncpy(buf, fname, len);
+    buf[len] = '\0';
+    return buf;
+  }
+  
+  const char* dot = strrchr(fname, '.');
+  if (dot && dot > fname) {
+    size_t len = dot - fname;
+    if (len > sizeof(buf)-1) len = sizeof(buf)-1;
+    strncpy(buf, fname, len);
+    buf[len] = '\0';
+    return buf;
+  }
+  strncpy(buf, fname, sizeof(buf)-1);
+  buf[sizeof(buf)-1] = '\0';
+  return buf;
+}
+
+#endif // RUN_TAG_H
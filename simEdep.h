@@ -0,0 +1,70 @@
+#ifndef SIM_EDEP_H
+#define SIM_EDEP_H
+
+// Simulation Edep histograms shared by both macros and the batch driver.
+// The simulation always describes the middle layer (layer 1, GeomID 9-16);
+// data of any layer is compared with the same column of that layer.
+// The set is loaded once, and its histograms are only read afterwards, so
+// one set can be shared by concurrent jobs.
+
+#include "TFile.h"
+#include "TH1.h"
+#include "caloMap.h"
+#include <iostream>
+
+constexpr int kSimLayer = 1;
+
+struct SimEdepSet {
+    TH1* hEdep[kCaloMaxGeom + 1] = {};   // detached clones, sim layer only
+    double mean[kCaloMaxGeom + 1] = {};  // mean Edep [MeV]
+
+    // Simulation GeomID in the same column as data GeomID geom
+    static int SimGeom(int geom) { return kSimLayer * 8 + (geom - 1) % 8 + 1; }
+
+    // Sum of the module means of the sim layer [MeV]
+    double TotalMean() const {
+        double total = 0.0;
+        for (int col = 0; col < 8; ++col) total += mean[kSimLayer * 8 + col + 1];
+        return total;
+    }
+};
+
+// Load Edep_M<geom> (or hSimEdep_<geom> / Edep_M<geom:02d>) for the sim layer;
+// false only if the file cannot be opened
+inline bool LoadSimEdep(const char* simFile, SimEdepSet& sim) {
+    TFile* fSim = TFile::Open(simFile, "READ");
+    if (!fSim || fSim->IsZombie()) {
+        std::cerr << "Error: cannot open sim file " << simFile << std::endl;
+        delete fSim;
+        return false;
+    }
+    std::cout << "\n=== Loading simulation data for layer " << kSimLayer << " (GeomID "
+              << (kSimLayer * 8 + 1) << "-" << (kSimLayer * 8 + 8) << ") from " << simFile
+              << " ===" << std::endl;
+    for (int col = 0; col < 8; ++col) {
+        int geom = kSimLayer * 8 + col + 1;
+        TH1* hOrig = dynamic_cast<TH1*>(fSim->Get(Form("Edep_M%d", geom)));
+        if (!hOrig) hOrig = dynamic_cast<TH1*>(fSim->Get(Form("hSimEdep_%d", geom)));
+        if (!hOrig) hOrig = dynamic_cast<TH1*>(fSim->Get(Form("Edep_M%02d", geom)));
+        if (!hOrig) {
+            std::cout << "Warning: sim hist Edep_M" << geom << " missing" << std::endl;
+            continue;
+        }
+        sim.hEdep[geom] = (TH1*)hOrig->Clone(Form("hSimEdep_G%d", geom));
+        sim.hEdep[geom]->SetDirectory(0);
+        sim.mean[geom] = hOrig->GetMean(); // full module energy, no 0.5 scaling
+        std::cout << "Loaded sim GeomID " << geom << ": mean = " << sim.mean[geom] << " MeV" << std::endl;
+    }
+    fSim->Close();
+    delete fSim;
+    return true;
+}
+
+inline void DeleteSimEdep(SimEdepSet& sim) {
+    for (int g = 0; g <= kCaloMaxGeom; ++g) {
+        delete sim.hEdep[g];
+        sim.hEdep[g] = nullptr;
+    }
+}
+
+#endif // SIM_EDEP_H
@@ -0,0 +1,91 @@
+#ifndef WAVEFORM_INTEGRAL_H
+#define WAVEFORM_INTEGRAL_H
+
+// ADC integration of the flattened event-builder waveform.
+// waveform_total interleaves ADC and TDC samples, so a channel's ADC samples
+// are every other short starting at its waveform_idx. The window is clamped
+// to the waveform once per channel and the even-offset samples are summed with
+// SIMD (AVX2 or SSE2 when the compiler targets them, scalar otherwise).
+
+#include <vector>
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+namespace waveform_detail {
+
+// Sum of p[0], p[2], ... p[k] with k < n
+inline long long SumEvenScalar(const short* p, long n) {
+    long long sum = 0;
+    for (long k = 0; k < n; k += 2) sum += p[k];
+    return sum;
+}
+
+#if defined(__AVX2__)
+inline long long SumEven(const short* p, long n) {
+    // madd with (1,0,1,0,...) keeps the ADC lanes and widens them to int32
+    const __m256i adcMask = _mm256_set1_epi32(1);
+    const long kFlush = 16L << 15; // int32 lanes cannot overflow within this span
+    long long sum = 0;
+    long k = 0;
+    while (k + 16 <= n) {
+        __m256i acc = _mm256_setzero_si256();
+        long stop = (n < k + kFlush) ? n : k + kFlush;
+        for (; k + 16 <= stop; k += 16) {
+            __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p + k));
+            acc = _mm256_add_epi32(acc, _mm256_madd_epi16(v, adcMask));
+        }
+        alignas(32) int lanes[8];
+        _mm256_store_si256(reinterpret_cast<__m256i*>(lanes), acc);
+        for (int l = 0; l < 8; ++l) sum += lanes[l];
+    }
+    return sum + SumEvenScalar(p + k, n - k);
+}
+#elif defined(__SSE2__)
+inline long long SumEven(const short* p, long n) {
+    // madd with (1,0,1,0,...) keeps the ADC lanes and widens them to int32
+    const __m128i adcMask = _mm_set1_epi32(1);
+    const long kFlush = 8L << 15; // int32 lanes cannot overflow within this span
+    long long sum = 0;
+    long k = 0;
+    while (k + 8 <= n) {
+        __m128i acc = _mm_setzero_si128();
+        long stop = (n < k + kFlush) ? n : k + kFlush;
+        for (; k + 8 <= stop; k += 8) {
+            __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + k));
+            acc = _mm_add_epi32(acc, _mm_madd_epi16(v, adcMask));
+        }
+        alignas(16) int lanes[4];
+        _mm_store_si128(reinterpret_cast<__m128i*>(lanes), acc);
+        for (int l = 0; l < 4; ++l) sum += lanes[l];
+    }
+    return sum + SumEvenScalar(p + k, n - k);
+}
+#else
+inline long long SumEven(const short* p, long n) {
+    return SumEvenScalar(p, n);
+}
+#endif
+
+} // namespace waveform_detail
+
+// Sum of the ADC samples wave[start], wave[start+2], ... inside [start, end),
+// restricted to [0, size), minus pedestal per summed sample.
+inline double IntegrateADC(const short* wave, long size, long start, long end,
+                           double pedestal = 0.0) {
+    if (start < 0) start += ((1 - start) / 2) * 2; // first in-range sample, same parity
+    if (end > size) end = size;
+    if (start >= end) return 0.0;
+    long n = end - start;
+    double sum = static_cast<double>(waveform_detail::SumEven(wave + start, n));
+    return (pedestal != 0.0) ? sum - pedestal * ((n + 1) / 2) : sum;
+}
+
+inline double IntegrateADC(const std::vector<short>& wave, long start, long end,
+                           double pedestal = 0.0) {
+    return IntegrateADC(wave.data(), static_cast<long>(wave.size()), start, end, pedestal);
+}
+
+#endif // WAVEFORM_INTEGRAL_H